@@ -1,6 +1,12 @@
 ﻿#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include"compressed_trie.h"
 
+// below this many nodes (in both tries together) the set operations stay on one thread
+const int PARALLEL_THRESHOLD = 4096;
+
 // constructor
 CompressedTrie::CompressedTrie() {
     // initialize the root
@@ -9,11 +15,30 @@ CompressedTrie::CompressedTrie() {
     // since we need to save strings in it
     root = new TrieNode();
 }
+
+// move constructor, the set operations hand their result back through it
+CompressedTrie::CompressedTrie(CompressedTrie&& other) {
+    root = other.root;
+    // leave the other trie empty but still usable
+    other.root = new TrieNode();
+}
+
+// move assignment, the current tree is deleted first
+CompressedTrie& CompressedTrie::operator=(CompressedTrie&& other) {
+    if (this != &other) {
+        // allocate before touching anything, so a failure leaves both tries as they were
+        TrieNode* newRoot = new TrieNode();
+        clear(root);
+        root = other.root;
+        other.root = newRoot;
+    }
+    return *this;
+}
 /**
  * use recursion to delete the entire tree
  * notice we must delete from the leaf
  */
-void CompressedTrie::clear(TrieNode* node) {
+void CompressedTrie::clear(TrieNode* node) const {
     if (node) {
         for (int i = 0; i < SIZE; ++i) {
             clear(node->children[i]);
@@ -240,6 +265,235 @@ bool CompressedTrie::removeHelper(TrieNode*& node, const string& word) {
     }
 }
 
+// the words contained in either trie
+CompressedTrie CompressedTrie::merge(const CompressedTrie& other) const {
+    return setOperation(other, UNION);
+}
+
+// the words contained in both tries
+CompressedTrie CompressedTrie::intersect(const CompressedTrie& other) const {
+    return setOperation(other, INTERSECTION);
+}
+
+// the words contained in this trie but not in the other one
+CompressedTrie CompressedTrie::difference(const CompressedTrie& other) const {
+    return setOperation(other, DIFFERENCE);
+}
+
+/**
+ * run work(slot) for every slot, spread over at most one thread per core when
+ * parallel is set, otherwise one by one on the calling thread
+ * every started thread is joined before an exception leaves this function
+ */
+static void runSlots(const vector<int>& slots, const function<void(int)>& work, bool parallel) {
+    int workerCount = min<int>(slots.size(), thread::hardware_concurrency());
+    if (!parallel || workerCount < 2) {
+        for (int slot : slots) {
+            work(slot);
+        }
+        return;
+    }
+    vector<thread> workers;
+    vector<exception_ptr> errors(workerCount);
+    auto joinAll = [&workers]() {
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+    try {
+        for (int w = 0; w < workerCount; ++w) {
+            // worker w takes the slots w, w + workerCount, ...
+            workers.emplace_back([&slots, &work, &errors, w, workerCount]() {
+                try {
+                    for (size_t k = w; k < slots.size(); k += workerCount) {
+                        work(slots[k]);
+                    }
+                }
+                catch (...) {
+                    errors[w] = current_exception();
+                }
+            });
+        }
+    }
+    catch (...) {
+        // a thread could not be started, wait for the ones already running
+        joinAll();
+        throw;
+    }
+    joinAll();
+    for (auto& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * walk the two trees in lockstep and build the result node by node, instead of
+ * enumerating one trie and inserting every key from the root again
+ * the subtrees under different children of the root never share a word, so
+ * for large tries they are handled by several threads
+ */
+CompressedTrie CompressedTrie::setOperation(const CompressedTrie& other, SetOp op) const {
+    CompressedTrie result;
+    // the root is gone once the last word of a trie has been removed
+    vector<int> slots;
+    for (int i = 0; i < SIZE; ++i) {
+        TrieNode* child = root ? root->children[i] : nullptr;
+        TrieNode* otherChild = other.root ? other.root->children[i] : nullptr;
+        // only the roads that exist in at least one trie
+        if (child != nullptr || otherChild != nullptr) {
+            slots.push_back(i);
+        }
+    }
+    bool parallel = countHelper(root, PARALLEL_THRESHOLD) + countHelper(other.root, PARALLEL_THRESHOLD) >= PARALLEL_THRESHOLD;
+    // every slot only writes its own child of the new root
+    runSlots(slots, [this, &other, &result, op](int i) {
+        TrieNode* child = root ? root->children[i] : nullptr;
+        TrieNode* otherChild = other.root ? other.root->children[i] : nullptr;
+        string key = child ? child->key : "";
+        string otherKey = otherChild ? otherChild->key : "";
+        result.root->children[i] = setOperationHelper(child, key, otherChild, otherKey, op);
+    }, parallel);
+    return result;
+}
+
+/**
+* key is the part of node's string not matched yet (the whole node->key, or its suffix
+* when the edge was split by an earlier step), the same for otherKey
+* both keys start with the same char, we compare the two edges, and after the common
+* part each trie either goes on inside the rest of its edge or into its children
+* return the node of the result (nullptr if no word of the result goes through it)
+*/
+CompressedTrie::TrieNode* CompressedTrie::setOperationHelper(TrieNode* node, const string& key, TrieNode* otherNode, const string& otherKey, SetOp op) const {
+    // base case 1: the edge exists in neither trie
+    if (node == nullptr && otherNode == nullptr) {
+        return nullptr;
+    }
+    // base case 2: only this trie has the edge, the whole subtree is kept or dropped
+    if (otherNode == nullptr) {
+        return op == INTERSECTION ? nullptr : copyHelper(node, key);
+    }
+    // base case 3: only the other trie has the edge
+    if (node == nullptr) {
+        return op == UNION ? copyHelper(otherNode, otherKey) : nullptr;
+    }
+    // curLength: the common prefix length of the two edges
+    size_t curLength = 0;
+    while (curLength < key.length() && curLength < otherKey.length()
+        && key[curLength] == otherKey[curLength]) {
+        curLength++;
+    }
+    bool keyEnds = curLength == key.length();
+    bool otherKeyEnds = curLength == otherKey.length();
+    TrieNode* newNode = new TrieNode();
+    try {
+        newNode->key = key.substr(0, curLength);
+        // a node only stands for a word when its whole edge is matched
+        bool inThis = keyEnds && node->endOfWord;
+        bool inOther = otherKeyEnds && otherNode->endOfWord;
+        switch (op) {
+        case UNION:
+            newNode->endOfWord = inThis || inOther;
+            break;
+        case INTERSECTION:
+            newNode->endOfWord = inThis && inOther;
+            break;
+        case DIFFERENCE:
+            newNode->endOfWord = inThis && !inOther;
+            break;
+        }
+        for (int i = 0; i < SIZE; ++i) {
+            // the road starting with char i in this trie: a child when the edge is finished,
+            // otherwise the rest of the edge itself
+            TrieNode* child = nullptr;
+            string childKey = "";
+            if (keyEnds) {
+                child = node->children[i];
+                childKey = child ? child->key : "";
+            }
+            else if (node->get(key[curLength]) == i) {
+                child = node;
+                childKey = key.substr(curLength);
+            }
+            // the same for the other trie
+            TrieNode* otherChild = nullptr;
+            string otherChildKey = "";
+            if (otherKeyEnds) {
+                otherChild = otherNode->children[i];
+                otherChildKey = otherChild ? otherChild->key : "";
+            }
+            else if (otherNode->get(otherKey[curLength]) == i) {
+                otherChild = otherNode;
+                otherChildKey = otherKey.substr(curLength);
+            }
+            newNode->children[i] = setOperationHelper(child, childKey, otherChild, otherChildKey, op);
+        }
+        if (newNode->endOfWord) {
+            return newNode;
+        }
+        // no word of the result goes through this node, remove it
+        if (newNode->isLeaf()) {
+            delete newNode;
+            return nullptr;
+        }
+        // a single child and not a word: merge the two edges to keep the trie compressed
+        int count = 0;
+        TrieNode* onlyChild = nullptr;
+        for (auto& child : newNode->children) {
+            if (child != nullptr) {
+                count++;
+                onlyChild = child;
+            }
+        }
+        if (count == 1) {
+            onlyChild->key = newNode->key + onlyChild->key;
+            delete newNode;
+            return onlyChild;
+        }
+        return newNode;
+    }
+    catch (...) {
+        // nothing owns newNode yet, free it and what was built under it
+        clear(newNode);
+        throw;
+    }
+}
+
+// deep copy of the subtree, using key as the string of the copied node
+CompressedTrie::TrieNode* CompressedTrie::copyHelper(TrieNode* node, const string& key) const {
+    if (node == nullptr) {
+        return nullptr;
+    }
+    TrieNode* newNode = new TrieNode();
+    try {
+        newNode->key = key;
+        newNode->endOfWord = node->endOfWord;
+        for (int i = 0; i < SIZE; ++i) {
+            TrieNode* child = node->children[i];
+            newNode->children[i] = copyHelper(child, child ? child->key : "");
+        }
+    }
+    catch (...) {
+        // nothing owns newNode yet, free it and what was built under it
+        clear(newNode);
+        throw;
+    }
+    return newNode;
+}
+
+// count the nodes of the subtree, but stop as soon as limit is reached
+int CompressedTrie::countHelper(TrieNode* node, int limit) const {
+    if (node == nullptr || limit <= 0) {
+        return 0;
+    }
+    int count = 1;
+    for (int i = 0; i < SIZE && count < limit; ++i) {
+        count += countHelper(node->children[i], limit - count);
+    }
+    return count;
+}
+
 int main()
 {
     // test
@@ -285,6 +539,52 @@ int main()
     test.remove("shaopu");
     cout << "search result of another word " << "shaopu" << ": " << test.search("shaopu", false) << endl;
 
+    cout << "------------merge & intersect & difference------------" << endl;
+    CompressedTrie other;
+    other.insert("answer");
+    other.insert("anyone");
+    other.insert("hero");
+    other.insert("berkeley");
+    other.insert("zoo");
+    CompressedTrie merged = test.merge(other);
+    CompressedTrie common = test.intersect(other);
+    CompressedTrie removed = test.difference(other);
+    cout << "merge result of zoo: " << merged.search("zoo", false) << endl;
+    cout << "merge result of anyone: " << merged.search("anyone", false) << endl;
+    cout << "merge result of combine: " << merged.search("combine", false) << endl;
+    cout << "intersect result of hero: " << common.search("hero", false) << endl;
+    cout << "intersect result of berkeley: " << common.search("berkeley", false) << endl;
+    cout << "intersect result of heroplane: " << common.search("heroplane", false) << endl;
+    cout << "difference result of berkeley: " << removed.search("berkeley", false) << endl;
+    cout << "difference result of bye: " << removed.search("bye", false) << endl;
+    cout << "difference result of heroplane: " << removed.search("heroplane", false) << endl;
+
+    // removing the last word of a trie deletes its root
+    CompressedTrie emptied;
+    emptied.insert("abc");
+    emptied.remove("abc");
+    CompressedTrie kept = other.merge(emptied);
+    cout << "merge with an emptied trie, result of zoo: " << kept.search("zoo", false) << endl;
+    // move assignment replaces the old tree
+    kept = emptied.difference(other);
+    cout << "difference of an emptied trie, result of zoo: " << kept.search("zoo", false) << endl;
+
+    // large enough to be walked by several threads
+    CompressedTrie big, otherBig;
+    for (char x = 'a'; x <= 'z'; ++x) {
+        for (char y = 'a'; y <= 'z'; ++y) {
+            for (char z = 'a'; z <= 'z'; ++z) {
+                big.insert(string{ x, y, z });
+                if (z % 2 == 0) {
+                    otherBig.insert(string{ x, y, z });
+                }
+            }
+        }
+    }
+    CompressedTrie odd = big.difference(otherBig);
+    cout << "difference result of abc: " << odd.search("abc", false) << endl;
+    cout << "difference result of abd: " << odd.search("abd", false) << endl;
+
     return 0;
 }
 
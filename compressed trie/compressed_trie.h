@@ -4,6 +4,7 @@
 #include<iostream>
 #include<string>
 #include<vector>
+#include<thread>
 
 using namespace std;
 const int SIZE = 26;
@@ -54,17 +55,28 @@ private:
     int matchHelper(vector<string>& remains, string nodeWord, string newWord);
     void traverseHelper(TrieNode*& node);
     void reConnectHelper(TrieNode*& newNode, TrieNode*& node, string& nodeWord, int curLength);
+    // the set operations share one lockstep walk
+    enum SetOp { UNION, INTERSECTION, DIFFERENCE };
+    CompressedTrie setOperation(const CompressedTrie& other, SetOp op) const;
+    TrieNode* setOperationHelper(TrieNode* node, const string& key, TrieNode* otherNode, const string& otherKey, SetOp op) const;
+    TrieNode* copyHelper(TrieNode* node, const string& key) const;
+    int countHelper(TrieNode* node, int limit) const;
     // the root of the DST
     TrieNode* root;
 
 public:
     CompressedTrie();
+    CompressedTrie(CompressedTrie&& other);
+    CompressedTrie& operator=(CompressedTrie&& other);
     ~CompressedTrie();
     void insert(const string& word);
     bool remove(const string& word);
     bool search(const string& word, bool isPrefix);
     void traverse();
-    void clear(TrieNode* node);
+    CompressedTrie merge(const CompressedTrie& other) const;
+    CompressedTrie intersect(const CompressedTrie& other) const;
+    CompressedTrie difference(const CompressedTrie& other) const;
+    void clear(TrieNode* node) const;
 
 };
 
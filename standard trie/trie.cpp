@@ -1,7 +1,13 @@
 ﻿#include <iostream>
 #include <string>
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include "trie.h"
 
+// below this many nodes (in both tries together) the set operations stay on one thread
+const int PARALLEL_THRESHOLD = 4096;
+
 // constructor
 Trie::Trie() {
     // initialize the root
@@ -10,6 +16,26 @@ Trie::Trie() {
     cur_size = 0;
 }
 
+// move constructor, the set operations hand their result back through it
+Trie::Trie(Trie&& other) noexcept {
+    root = other.root;
+    cur_size = other.cur_size;
+    other.root = nullptr;
+    other.cur_size = 0;
+}
+
+// move assignment, the current tree is deleted first
+Trie& Trie::operator=(Trie&& other) noexcept {
+    if (this != &other) {
+        clear(root);
+        root = other.root;
+        cur_size = other.cur_size;
+        other.root = nullptr;
+        other.cur_size = 0;
+    }
+    return *this;
+}
+
 // deconstructor
 Trie::~Trie() {
     clear(root);
@@ -19,7 +45,7 @@ Trie::~Trie() {
  * use recursion to delete the entire tree
  * notice we must delete from the leaf
  */
-void Trie::clear(TrieNode* node) {
+void Trie::clear(TrieNode* node) const {
     if (node) {
         for (int i = 0; i < SIZE; ++i) {
             clear(node->children[i]);
@@ -206,6 +232,200 @@ void Trie::keysWithPrefixHelper(TrieNode*& node, vector<string>& chosen, string
 
 }
 
+// the words contained in either trie
+Trie Trie::merge(const Trie& other) const {
+    return setOperation(other, UNION);
+}
+
+// the words contained in both tries
+Trie Trie::intersect(const Trie& other) const {
+    return setOperation(other, INTERSECTION);
+}
+
+// the words contained in this trie but not in the other one
+Trie Trie::difference(const Trie& other) const {
+    return setOperation(other, DIFFERENCE);
+}
+
+/**
+ * run work(slot) for every slot, spread over at most one thread per core when
+ * parallel is set, otherwise one by one on the calling thread
+ * every started thread is joined before an exception leaves this function
+ */
+static void runSlots(const vector<int>& slots, const function<void(int)>& work, bool parallel) {
+    int workerCount = min<int>(slots.size(), thread::hardware_concurrency());
+    if (!parallel || workerCount < 2) {
+        for (int slot : slots) {
+            work(slot);
+        }
+        return;
+    }
+    vector<thread> workers;
+    vector<exception_ptr> errors(workerCount);
+    auto joinAll = [&workers]() {
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+    try {
+        for (int w = 0; w < workerCount; ++w) {
+            // worker w takes the slots w, w + workerCount, ...
+            workers.emplace_back([&slots, &work, &errors, w, workerCount]() {
+                try {
+                    for (size_t k = w; k < slots.size(); k += workerCount) {
+                        work(slots[k]);
+                    }
+                }
+                catch (...) {
+                    errors[w] = current_exception();
+                }
+            });
+        }
+    }
+    catch (...) {
+        // a thread could not be started, wait for the ones already running
+        joinAll();
+        throw;
+    }
+    joinAll();
+    for (auto& error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * walk the two trees in lockstep and build the result node by node, instead of
+ * enumerating one trie and inserting every key from the root again
+ * the subtrees under different children of the root never share a word, so
+ * for large tries they are handled by several threads
+ */
+Trie Trie::setOperation(const Trie& other, SetOp op) const {
+    Trie result;
+    // the result owns its root from the start, so a failed walk frees what was built
+    result.root = new TrieNode();
+    int counts[SIZE] = {};
+    // the roads that exist in at least one trie
+    vector<int> slots;
+    for (int i = 0; i < SIZE; ++i) {
+        TrieNode* child = root ? root->children[i] : nullptr;
+        TrieNode* otherChild = other.root ? other.root->children[i] : nullptr;
+        if (child != nullptr || otherChild != nullptr) {
+            slots.push_back(i);
+        }
+    }
+    bool parallel = countHelper(root, PARALLEL_THRESHOLD) + countHelper(other.root, PARALLEL_THRESHOLD) >= PARALLEL_THRESHOLD;
+    // every slot only writes its own child of the new root and its own count
+    runSlots(slots, [this, &other, &result, &counts, op](int i) {
+        TrieNode* child = root ? root->children[i] : nullptr;
+        TrieNode* otherChild = other.root ? other.root->children[i] : nullptr;
+        result.root->children[i] = setOperationHelper(child, otherChild, op, counts[i]);
+    }, parallel);
+    // the root itself stands for the empty word
+    bool inThis = root && root->endOfWord;
+    bool inOther = other.root && other.root->endOfWord;
+    result.root->endOfWord = (op == UNION && (inThis || inOther))
+        || (op == INTERSECTION && inThis && inOther)
+        || (op == DIFFERENCE && inThis && !inOther);
+    result.cur_size = result.root->endOfWord ? 1 : 0;
+    for (int i = 0; i < SIZE; ++i) {
+        result.cur_size += counts[i];
+    }
+    // keep the root null for an empty result, like a newly constructed trie
+    if (result.cur_size == 0) {
+        delete result.root;
+        result.root = nullptr;
+    }
+    return result;
+}
+
+/**
+ * node and otherNode stand for the same prefix in the two tries
+ * return the node of this prefix in the result (nullptr if no word of the result
+ * goes through it), count is increased by the words stored under it
+ */
+Trie::TrieNode* Trie::setOperationHelper(TrieNode* node, TrieNode* otherNode, SetOp op, int& count) const {
+    // base case 1: the prefix exists in neither trie
+    if (node == nullptr && otherNode == nullptr) {
+        return nullptr;
+    }
+    // base case 2: only this trie has the prefix, the whole subtree is kept or dropped
+    if (otherNode == nullptr) {
+        return op == INTERSECTION ? nullptr : copyHelper(node, count);
+    }
+    // base case 3: only the other trie has the prefix
+    if (node == nullptr) {
+        return op == UNION ? copyHelper(otherNode, count) : nullptr;
+    }
+    TrieNode* newNode = new TrieNode();
+    switch (op) {
+    case UNION:
+        newNode->endOfWord = node->endOfWord || otherNode->endOfWord;
+        break;
+    case INTERSECTION:
+        newNode->endOfWord = node->endOfWord && otherNode->endOfWord;
+        break;
+    case DIFFERENCE:
+        newNode->endOfWord = node->endOfWord && !otherNode->endOfWord;
+        break;
+    }
+    if (newNode->endOfWord) {
+        count++;
+    }
+    try {
+        for (int i = 0; i < SIZE; ++i) {
+            newNode->children[i] = setOperationHelper(node->children[i], otherNode->children[i], op, count);
+        }
+    }
+    catch (...) {
+        // nothing owns newNode yet, free it and what was built under it
+        clear(newNode);
+        throw;
+    }
+    // no word of the result goes through this node, remove it
+    if (newNode->isLeaf() && !newNode->endOfWord) {
+        delete newNode;
+        return nullptr;
+    }
+    return newNode;
+}
+
+// deep copy of the subtree, count is increased by the words stored in it
+Trie::TrieNode* Trie::copyHelper(TrieNode* node, int& count) const {
+    if (node == nullptr) {
+        return nullptr;
+    }
+    TrieNode* newNode = new TrieNode();
+    newNode->endOfWord = node->endOfWord;
+    if (newNode->endOfWord) {
+        count++;
+    }
+    try {
+        for (int i = 0; i < SIZE; ++i) {
+            newNode->children[i] = copyHelper(node->children[i], count);
+        }
+    }
+    catch (...) {
+        // nothing owns newNode yet, free it and what was built under it
+        clear(newNode);
+        throw;
+    }
+    return newNode;
+}
+
+// count the nodes of the subtree, but stop as soon as limit is reached
+int Trie::countHelper(TrieNode* node, int limit) const {
+    if (node == nullptr || limit <= 0) {
+        return 0;
+    }
+    int count = 1;
+    for (int i = 0; i < SIZE && count < limit; ++i) {
+        count += countHelper(node->children[i], limit - count);
+    }
+    return count;
+}
+
 int main() {
     // test
     string keys[] = { "the", "a", "there",
@@ -261,6 +481,47 @@ int main() {
     for (auto& word : chosen) {
         cout << word << endl;
     }
+
+    cout << "------------merge & intersect & difference------------" << endl;
+    Trie other;
+    other.insert("answer");
+    other.insert("anyone");
+    other.insert("hero");
+    other.insert("zoo");
+    Trie merged = test.merge(other);
+    Trie common = test.intersect(other);
+    Trie removed = test.difference(other);
+    cout << "merge result of zoo: " << merged.search("zoo", false) << endl;
+    cout << "merge result of anyone: " << merged.search("anyone", false) << endl;
+    cout << "merge result of the: " << merged.search("the", false) << endl;
+    cout << "intersect result of hero: " << common.search("hero", false) << endl;
+    cout << "intersect result of heroplane: " << common.search("heroplane", false) << endl;
+    cout << "difference result of hero: " << removed.search("hero", false) << endl;
+    cout << "difference result of heroplane: " << removed.search("heroplane", false) << endl;
+    chosen = merged.keysWithPrefix("an");
+    for (auto& word : chosen) {
+        cout << word << endl;
+    }
+    // move assignment replaces the old tree
+    merged = removed.difference(test);
+    cout << "difference of a trie and its superset is empty: " << !merged.search("", true) << endl;
+
+    // large enough to be walked by several threads
+    Trie big, otherBig;
+    for (char x = 'a'; x <= 'z'; ++x) {
+        for (char y = 'a'; y <= 'z'; ++y) {
+            for (char z = 'a'; z <= 'z'; ++z) {
+                big.insert(string{ x, y, z });
+                if (z % 2 == 0) {
+                    otherBig.insert(string{ x, y, z });
+                }
+            }
+        }
+    }
+    Trie odd = big.difference(otherBig);
+    cout << "difference result of abc: " << odd.search("abc", false) << endl;
+    cout << "difference result of abd: " << odd.search("abd", false) << endl;
+
     ////test.keysWithPrefix("wer");
     //test.keysWithPrefix("an");
 
@@ -4,6 +4,7 @@
 #include<iostream>
 #include<string>
 #include<vector>
+#include<thread>
 
 using namespace std;
 const int SIZE = 26;
@@ -47,19 +48,30 @@ private:
     bool removeHelper(TrieNode*& node, const string& word, int index);
     int longestPrefixHelper(TrieNode*& node, const string& word, int index, int length);
     void keysWithPrefixHelper(TrieNode*& node, vector<string>& chosen, string word, int index, int length);
+    // the set operations share one lockstep walk
+    enum SetOp { UNION, INTERSECTION, DIFFERENCE };
+    Trie setOperation(const Trie& other, SetOp op) const;
+    TrieNode* setOperationHelper(TrieNode* node, TrieNode* otherNode, SetOp op, int& count) const;
+    TrieNode* copyHelper(TrieNode* node, int& count) const;
+    int countHelper(TrieNode* node, int limit) const;
     // the root of the DST
     TrieNode* root;
     int cur_size;
 
 public:
     Trie();
+    Trie(Trie&& other) noexcept;
+    Trie& operator=(Trie&& other) noexcept;
     ~Trie();
     void insert(const string& word);
     bool remove(const string& word);
     bool search(const string& word, bool isPrefix);
     string longestPrefix(const string& word);
     vector<string> keysWithPrefix(const string& word);
-    void clear(TrieNode* node);
+    Trie merge(const Trie& other) const;
+    Trie intersect(const Trie& other) const;
+    Trie difference(const Trie& other) const;
+    void clear(TrieNode* node) const;
 
 };
 
@@ -0,0 +1,50 @@
+#include <iostream>
+#include "static_trie.h"
+
+// the dictionary is fixed, so the whole trie is built by the compiler
+constexpr const char* keys[] = { "the", "a", "there",
+                                "answer", "any", "by",
+                                "bye", "their", "hero", "heroplane" };
+constexpr auto test = makeStaticTrie<keys>();
+
+// lookups on a constexpr trie can be checked at compile time as well
+static_assert(test.size() == 10, "every key should be a word");
+static_assert(test.search("there", false), "there should be a word");
+static_assert(!test.search("her", false), "her is only a prefix");
+static_assert(test.search("her", true), "her should be a prefix");
+static_assert(test.longestPrefix("theirwe") == "their", "their is the longest word");
+static_assert(!test.search("The", false), "chars no key contains never match");
+static_assert(test.longestPrefix("there-in") == "there", "the match stops at a char no key contains");
+
+// the alphabet comes from the keys, so HTTP header names work as they are
+constexpr const char* headers[] = { "Content-Type", "Content-Length", "Host", "X-Forwarded-For" };
+constexpr auto headerTrie = makeStaticTrie<headers>();
+static_assert(headerTrie.search("Content-Type", false), "Content-Type should be a word");
+static_assert(headerTrie.search("X-Forwarded-For", false), "X-Forwarded-For should be a word");
+static_assert(headerTrie.search("Content-", true), "Content- should be a prefix");
+static_assert(!headerTrie.search("content-type", false), "the lookup is case-sensitive");
+static_assert(!headerTrie.search("Host:", false), "':' is in no key");
+static_assert(headerTrie.longestPrefix("Host: example") == "Host", "Host is the longest word");
+
+int main() {
+    // test if the words already exist? also test search function
+    cout << "------------search------------" << endl;
+    for (auto& key : keys) {
+        cout << "search result of " << key << ": " << test.search(key, false) << endl;
+    }
+    cout << "search result of another word " << "shaopu" << ": " << test.search("shaopu", false) << endl;
+    cout << "search result of prefix " << "her" << ": " << test.search("her", true) << endl;
+    cout << "search result of another word " << "Content-Type" << ": " << test.search("Content-Type", false) << endl;
+
+    cout << "------------longestPrefix------------" << endl;
+    cout << test.longestPrefix("thewe") << endl;
+    cout << test.longestPrefix("their") << endl;
+    cout << test.longestPrefix("theirwe") << endl;
+    cout << test.longestPrefix("ans") << endl;
+    cout << test.longestPrefix("wefwe") << endl;
+    cout << test.longestPrefix("answerasd") << endl;
+    cout << test.longestPrefix("therwer") << endl;
+    cout << test.longestPrefix("any-one") << endl;
+
+    return 0;
+}
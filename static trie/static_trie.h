@@ -0,0 +1,223 @@
+#ifndef _STATIC_TRIE_H
+#define _STATIC_TRIE_H
+
+#include<cstddef>
+#include<stdexcept>
+#include<string_view>
+
+using namespace std;
+
+/**
+ * count how many nodes a standard trie needs to hold the given keys (the root included)
+ * a prefix only gets a new node the first time it shows up, so for every key we
+ * count the prefixes that no earlier key has already created
+ */
+template <size_t N>
+constexpr size_t countNodes(const char* const (&keys)[N]) {
+    size_t count = 1;
+    for (size_t i = 0; i < N; ++i) {
+        string_view word = keys[i];
+        for (size_t length = 1; length <= word.length(); ++length) {
+            bool seen = false;
+            for (size_t j = 0; j < i && !seen; ++j) {
+                string_view other = keys[j];
+                seen = other.length() >= length && other.substr(0, length) == word.substr(0, length);
+            }
+            if (!seen) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * count how many different chars the given keys use, every one of them gets a
+ * column in the children table of a node
+ */
+template <size_t N>
+constexpr size_t countChars(const char* const (&keys)[N]) {
+    bool seen[128] = {};
+    size_t count = 0;
+    for (size_t i = 0; i < N; ++i) {
+        string_view word = keys[i];
+        for (char ch : word) {
+            int index = ch;
+            if (index >= 0 && !seen[index]) {
+                seen[index] = true;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * a standard trie built entirely at compile time from a fixed list of string literals
+ * the nodes live in a flat table and point to their children by index, so there is
+ * no allocation and no startup cost
+ * unlike Trie the alphabet is not a-z: every 7-bit ASCII char used by the keys gets
+ * its own column, so mixed-case and hyphenated keys (e.g. HTTP header names) work
+ *
+ * NODES and CHARS must be countNodes(keys) and countChars(keys), the constructor
+ * throws when they are not (a compile error for a constexpr trie), so prefer
+ * makeStaticTrie, which always gets them right, e.g.
+ *
+ *   constexpr const char* keywords[] = { "for", "if", "int" };
+ *   constexpr auto reserved = makeStaticTrie<keywords>();
+ *   static_assert(reserved.search("int", false));
+ */
+template <size_t NODES, size_t CHARS>
+class StaticTrie
+{
+private:
+    struct TrieNode
+    {
+        // index of the child in the node table, 0 means no child
+        // (the root sits at 0 and can never be somebody's child)
+        size_t children[CHARS] = {};
+        bool endOfWord = false;
+    };
+    // the node table, the root is nodes[0]
+    TrieNode nodes[NODES] = {};
+    // the column of every 7-bit ASCII char, -1 for the chars no key contains
+    int columns[128] = {};
+    // how many nodes of the table are in use
+    size_t used = 1;
+    int cur_size = 0;
+
+    // get the position of the pointer should go to
+    // -1 for a char no key contains
+    constexpr int get(char ch) const {
+        int index = ch;
+        if (index < 0) {
+            return -1;
+        }
+        return columns[index];
+    }
+
+    // give every char of the keys a column, in the order they first show up
+    template <size_t N>
+    constexpr void buildColumns(const char* const (&keys)[N]) {
+        for (int i = 0; i < 128; ++i) {
+            columns[i] = -1;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < N; ++i) {
+            string_view word = keys[i];
+            for (char ch : word) {
+                int index = ch;
+                // in a constant expression this throw is a compile error pointing here
+                if (index < 0) {
+                    throw invalid_argument("StaticTrie keys may only contain 7-bit ASCII chars");
+                }
+                if (columns[index] < 0) {
+                    if (count >= CHARS) {
+                        throw length_error("StaticTrie: CHARS too small for the key list");
+                    }
+                    columns[index] = count++;
+                }
+            }
+        }
+        if (count != CHARS) {
+            throw length_error("StaticTrie: CHARS too large for the key list");
+        }
+    }
+
+    constexpr void insert(string_view word) {
+        size_t node = 0;
+        for (size_t index = 0; index < word.length(); ++index) {
+            int nextChild = get(word[index]);
+            // this prefix does not exist yet, take the next free slot of the table
+            if (nodes[node].children[nextChild] == 0) {
+                if (used >= NODES) {
+                    throw length_error("StaticTrie: NODES too small for the key list");
+                }
+                nodes[node].children[nextChild] = used++;
+            }
+            node = nodes[node].children[nextChild];
+        }
+        // the same literal listed twice is still one word
+        if (!nodes[node].endOfWord) {
+            nodes[node].endOfWord = true;
+            cur_size++;
+        }
+    }
+
+public:
+    template <size_t N>
+    constexpr StaticTrie(const char* const (&keys)[N]) {
+        buildColumns(keys);
+        for (size_t i = 0; i < N; ++i) {
+            insert(keys[i]);
+        }
+        if (used != NODES) {
+            throw length_error("StaticTrie: NODES too large for the key list");
+        }
+    }
+
+    constexpr bool search(string_view word, bool isPrefix) const {
+        size_t node = 0;
+        for (size_t index = 0; index < word.length(); ++index) {
+            int nextChild = get(word[index]);
+            // a char no key contains, the word/prefix doesn't exist
+            if (nextChild < 0) {
+                return false;
+            }
+            node = nodes[node].children[nextChild];
+            // if we meet a missing child, then the word/prefix doesn't exist
+            if (node == 0) {
+                return false;
+            }
+        }
+        // if judging prefix
+        if (isPrefix) {
+            return true;
+        }
+        // if judging word
+        return nodes[node].endOfWord;
+    }
+
+    /**
+    * same as Trie::longestPrefix: the longest prefix of the given string which is
+    * also a word in the dictionary, returned as a view into the given string
+    */
+    constexpr string_view longestPrefix(string_view word) const {
+        size_t node = 0;
+        size_t length = 0;
+        for (size_t index = 0; index < word.length(); ++index) {
+            // update the length when we meet a word in the dict
+            if (nodes[node].endOfWord) {
+                length = index;
+            }
+            int nextChild = get(word[index]);
+            // a char no key contains, the match stops here
+            if (nextChild < 0) {
+                return word.substr(0, length);
+            }
+            node = nodes[node].children[nextChild];
+            // only parts of the string match the words in the dictionary
+            if (node == 0) {
+                return word.substr(0, length);
+            }
+        }
+        // reach the end of the given word, and this is a word too
+        if (nodes[node].endOfWord) {
+            length = word.length();
+        }
+        return word.substr(0, length);
+    }
+
+    constexpr int size() const {
+        return cur_size;
+    }
+
+};
+
+// build the trie of a constexpr key array, with the table sizes taken from the keys
+template <auto& keys>
+constexpr auto makeStaticTrie() {
+    return StaticTrie<countNodes(keys), countChars(keys)>(keys);
+}
+
+#endif